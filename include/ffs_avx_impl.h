@@ -4,14 +4,24 @@
 #include <cmath>
 #include <complex>
 #include <vector>
+#include <cstdint>
+#include <stdexcept>
 #include <immintrin.h>
 
+#include "ffs_half.h"
+
 #ifdef _MSC_VER // for MSVC
 #define RESTRICT __restrict
 #else // For GCC / clang
 #define RESTRICT __restrict__
 #endif
 
+// F16C is not implied by AVX. GCC/clang define __F16C__ (e.g. -mf16c or -march=x86-64-v3),
+// whereas MSVC only exposes it alongside /arch:AVX2.
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define FFS_HAS_F16C
+#endif
+
 #ifdef __APPLE__
 namespace ffsh
 #else
@@ -56,6 +66,45 @@ namespace ffs
         _mm256_storeu_ps(y, ymm2);
     }
 
+    static inline void floatToDoubleIntrinsic4(
+        const float * RESTRICT x, double * RESTRICT y
+    ){
+        __m128 xmm0 = _mm_loadu_ps(x);
+        __m256d ymm0 = _mm256_cvtps_pd(xmm0);
+
+        _mm256_storeu_pd(y, ymm0);
+    }
+
+    static inline void int16ToDoubleIntrinsic4(
+        const int16_t * RESTRICT x, double * RESTRICT y
+    ){
+        __m128i xmm0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(x));
+        __m128i xmm1 = _mm_cvtepi16_epi32(xmm0);
+        __m256d ymm0 = _mm256_cvtepi32_pd(xmm1);
+
+        _mm256_storeu_pd(y, ymm0);
+    }
+
+#ifdef FFS_HAS_F16C
+    static inline void halfToFloatIntrinsic8(
+        const uint16_t * RESTRICT x, float * RESTRICT y
+    ){
+        __m128i xmm0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x));
+        __m256 ymm0 = _mm256_cvtph_ps(xmm0);
+
+        _mm256_storeu_ps(y, ymm0);
+    }
+
+    static inline void floatToHalfIntrinsic8(
+        const float * RESTRICT x, uint16_t * RESTRICT y
+    ){
+        __m256 ymm0 = _mm256_loadu_ps(x);
+        __m128i xmm0 = _mm256_cvtps_ph(ymm0, _MM_FROUND_TO_NEAREST_INT);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(y), xmm0);
+    }
+#endif
+
     /// @brief Performs z[i] *= x[i] for i = 0,1,2,3
     static inline void complexMulIntrinsic_4x4_32fc(
         const std::complex<float> * RESTRICT x,
@@ -98,6 +147,25 @@ namespace ffs
         _mm256_storeu_pd(reinterpret_cast<double*>(z), ymm1);
     }
 
+    /// @brief Performs z[i] = x[i] * y[i] for i = 0,1, where x is real
+    /// @param x Real input array.
+    /// @param y Complex input array.
+    /// @param z Complex output array.
+    static inline void realMulIntrinsic_2x2_64fc(
+        const double * RESTRICT x,
+        const std::complex<double> * RESTRICT y,
+        std::complex<double> * RESTRICT z
+    ){
+        // Duplicate the reals to line up with the complex values i.e. x0 x0 x1 x1
+        __m256d ymm0 = _mm256_broadcast_pd(reinterpret_cast<const __m128d*>(x));
+        ymm0 = _mm256_permute_pd(ymm0, 12);
+        __m256d ymm1 = _mm256_loadu_pd(reinterpret_cast<const double*>(y));
+
+        ymm1 = _mm256_mul_pd(ymm0, ymm1);
+
+        _mm256_storeu_pd(reinterpret_cast<double*>(z), ymm1);
+    }
+
     /// @brief Performs z[i] *= x for i = 0,1
     /// @param x Constant to multiply into z
     /// @param z Input/output array vector. 
@@ -125,9 +193,99 @@ namespace ffs
 
 
 
+    /// @brief Shift an input complex array using precomputed tones; this is the kernel behind shiftArray.
+    /// ShiftPlan (see ffs_plan.h) calls this directly to pick the unroll.
+    /// @tparam UNROLL Number of tones, and samples per iteration. Must be a multiple of 4.
+    /// @param array Input complex array. Will be overwritten with the shifted values.
+    /// @param size Length of the input array.
+    /// @param tones Tones for the first UNROLL samples. Will be overwritten.
+    /// @param step Tone increment over UNROLL samples.
+    template <size_t UNROLL>
+    inline void shiftArrayWithTones(
+        std::complex<float> *array,
+        const size_t size,
+        std::complex<double> *tones,
+        const std::complex<double> &step
+    ){
+        static_assert(UNROLL % 4 == 0, "UNROLL must be a multiple of 4");
+
+        // Allocate stack array for input
+        std::complex<double> input[4];
+
+        // Main loop
+        for (size_t i = 0; i < size-size%UNROLL; i += UNROLL)
+        {
+            for (size_t j = 0; j < UNROLL; j += 4)
+            {
+                // Cast the input to double
+                floatToDoubleIntrinsic8(
+                    reinterpret_cast<float*>(&array[i+j]), 
+                    reinterpret_cast<double*>(input)
+                );
+
+                // Muliply with double type tones
+                complexMulIntrinsic_2x2_64fc(&tones[j+0], &input[0]);
+                complexMulIntrinsic_2x2_64fc(&tones[j+2], &input[2]);
+
+                // Load back to our input
+                doubleToFloatIntrinsic8(
+                    reinterpret_cast<double*>(input), 
+                    reinterpret_cast<float*>(&array[i+j])
+                );
+            }
+
+            // Increment tones
+            for (size_t j = 0; j < UNROLL; j += 2)
+                complexMulIntrinsic_2xScalar(step, &tones[j]);
+        }
+
+        // Remainder loop
+        for (size_t i = 0; i < size % UNROLL; ++i)
+        {
+            array[size-size%UNROLL + i] = static_cast<std::complex<float>>(
+                static_cast<std::complex<double>>(array[size-size%UNROLL + i]) * tones[i]
+            );
+        }
+    };
+
+    template <size_t UNROLL>
+    inline void shiftArrayWithTones(
+        std::complex<double> *array,
+        const size_t size,
+        std::complex<double> *tones,
+        const std::complex<double> &step
+    ){
+        // For doubles we can only fit 2 tones in the AVX registers,
+        // but we still require multiples of 4 for consistency with floats.
+        static_assert(UNROLL % 4 == 0, "UNROLL must be a multiple of 4");
+
+        // Main loop
+        for (size_t i = 0; i < size-size%UNROLL; i += UNROLL)
+        {
+            // Multiply into array
+            for (size_t j = 0; j < UNROLL; j += 2)
+            {
+                complexMulIntrinsic_2x2_64fc(
+                    &tones[j],
+                    &array[i+j]
+                );
+            }
+
+            // Increment tones
+            for (size_t j = 0; j < UNROLL; j += 2)
+                complexMulIntrinsic_2xScalar(step, &tones[j]);
+        }
+
+        // Remaining loops
+        for (size_t i = 0; i < size % UNROLL; ++i)
+        {
+            array[size-size%UNROLL + i] = array[size-size%UNROLL + i] * tones[i];
+        }
+    }
+
+
     /// @brief Shift an input complex array by a normalized frequency and start phase.
     /// @tparam T Data type of real/imag sample.
-    /// @tparam 4 Optimization parameter. Defaults to 1.
     /// @param array Input complex array. Will be overwritten with the shifted values.
     /// @param size Length of the input array.
     /// @param freq Normalized frequency i.e. [0, 1)
@@ -138,12 +296,65 @@ namespace ffs
         const size_t size,
         const double freq,
         const double startPhase
+    ){
+        // Allocate array for initial tones
+        std::complex<double> tones[4];
+
+        // Initialize them
+        for (size_t i = 0; i < 4; ++i)
+        {
+            tones[i] = std::complex<double>(std::cos(startPhase + i*2*M_PI*freq), std::sin(startPhase + i*2*M_PI*freq));
+        }
+
+        // Compute the step
+        std::complex<double> step(std::cos(2*M_PI*freq*4), std::sin(2*M_PI*freq*4));
+
+        // Only float and double have kernels
+        shiftArrayWithTones<4>(array, size, tones, step);
+    };
+
+
+    /// @brief Shift an input complex vector by a normalized frequency and start phase.
+    /// @tparam T Data type of real/imag sample.
+    /// @tparam U Data type for the tone and step real/imag values.
+    /// @tparam 4 Optimization parameter. Defaults to 1.
+    /// @param vec Input complex vector. Will be overwritten with the shifted values.
+    /// @param freq Normalized frequency i.e. [0, 1)
+    /// @param startPhase Start phase of the frequency shift in radians.
+    template <typename T>
+    void shiftVector(
+        std::vector<std::complex<T>> &vec,
+        const double freq,
+        const double startPhase
+    ){
+        // Call the shiftArray function
+        shiftArray<T>(vec.data(), vec.size(), freq, startPhase);
+    };
+
+
+    /// @brief Shift a real input array by a normalized frequency and start phase, into a complex output array.
+    /// Specialized for (T, U) = (float, float), (double, double) and (int16_t, float).
+    /// @tparam T Data type of input real sample.
+    /// @tparam U Data type of output real/imag sample.
+    /// @param in Input real array.
+    /// @param out Output complex array. Must have at least size elements.
+    /// @param size Length of the input array.
+    /// @param freq Normalized frequency i.e. [0, 1)
+    /// @param startPhase Start phase of the frequency shift in radians.
+    template <typename T, typename U>
+    void shiftRealArray(
+        const T *in,
+        std::complex<U> *out,
+        const size_t size,
+        const double freq,
+        const double startPhase
     );
 
 
     template <>
-    inline void shiftArray(
-        std::complex<float> *array,
+    inline void shiftRealArray(
+        const float *in,
+        std::complex<float> *out,
         const size_t size,
         const double freq,
         const double startPhase
@@ -160,27 +371,24 @@ namespace ffs
         // Compute the step
         std::complex<double> step(std::cos(2*M_PI*freq*4), std::sin(2*M_PI*freq*4));
 
-        // Allocate stack array for input
-        std::complex<double> input[4];
-
+        // Allocate stack arrays for input and output
+        double input[4];
+        std::complex<double> output[4];
 
         // Main loop
         for (size_t i = 0; i < size-size%4; i += 4)
         {
             // Cast the input to double
-            floatToDoubleIntrinsic8(
-                reinterpret_cast<float*>(&array[i]), 
-                reinterpret_cast<double*>(input)
-            );
+            floatToDoubleIntrinsic4(&in[i], input);
 
             // Muliply with double type tones
-            complexMulIntrinsic_2x2_64fc(&tones[0], &input[0]);
-            complexMulIntrinsic_2x2_64fc(&tones[2], &input[2]);
+            realMulIntrinsic_2x2_64fc(&input[0], &tones[0], &output[0]);
+            realMulIntrinsic_2x2_64fc(&input[2], &tones[2], &output[2]);
 
-            // Load back to our input
+            // Cast back to float for the output
             doubleToFloatIntrinsic8(
-                reinterpret_cast<double*>(input), 
-                reinterpret_cast<float*>(&array[i])
+                reinterpret_cast<double*>(output),
+                reinterpret_cast<float*>(&out[i])
             );
 
             // Increment tones
@@ -191,44 +399,89 @@ namespace ffs
         // Remainder loop
         for (size_t i = 0; i < size % 4; ++i)
         {
-            array[size-size%4 + i] = static_cast<std::complex<float>>(
-                static_cast<std::complex<double>>(array[size-size%4 + i]) * tones[i]
+            out[size-size%4 + i] = static_cast<std::complex<float>>(
+                static_cast<double>(in[size-size%4 + i]) * tones[i]
             );
         }
     };
 
     template <>
-    inline void shiftArray(
-        std::complex<double> *array,
+    inline void shiftRealArray(
+        const int16_t *in,
+        std::complex<float> *out,
         const size_t size,
         const double freq,
         const double startPhase
     ){
-        // We don't need the second array of tones for this, but
-        // we will keep it at 4 tones for consistency even though
-        // for doubles, we can only fit 2 tones in the AVX registers.
-
         // Allocate array for initial tones
         std::complex<double> tones[4];
+
         // Initialize them
         for (size_t i = 0; i < 4; ++i)
+        {
             tones[i] = std::complex<double>(std::cos(startPhase + i*2*M_PI*freq), std::sin(startPhase + i*2*M_PI*freq));
-        
+        }
+
         // Compute the step
         std::complex<double> step(std::cos(2*M_PI*freq*4), std::sin(2*M_PI*freq*4));
 
+        // Allocate stack arrays for input and output
+        double input[4];
+        std::complex<double> output[4];
+
         // Main loop
         for (size_t i = 0; i < size-size%4; i += 4)
         {
-            // Multiply into array
-            complexMulIntrinsic_2x2_64fc(
-                &tones[0],
-                &array[i+0]
+            // Cast the input to double
+            int16ToDoubleIntrinsic4(&in[i], input);
+
+            // Muliply with double type tones
+            realMulIntrinsic_2x2_64fc(&input[0], &tones[0], &output[0]);
+            realMulIntrinsic_2x2_64fc(&input[2], &tones[2], &output[2]);
+
+            // Cast back to float for the output
+            doubleToFloatIntrinsic8(
+                reinterpret_cast<double*>(output),
+                reinterpret_cast<float*>(&out[i])
             );
-            complexMulIntrinsic_2x2_64fc(
-                &tones[2],
-                &array[i+2]
+
+            // Increment tones
+            complexMulIntrinsic_2xScalar(step, &tones[0]);
+            complexMulIntrinsic_2xScalar(step, &tones[2]);
+        }
+
+        // Remainder loop
+        for (size_t i = 0; i < size % 4; ++i)
+        {
+            out[size-size%4 + i] = static_cast<std::complex<float>>(
+                static_cast<double>(in[size-size%4 + i]) * tones[i]
             );
+        }
+    };
+
+    template <>
+    inline void shiftRealArray(
+        const double *in,
+        std::complex<double> *out,
+        const size_t size,
+        const double freq,
+        const double startPhase
+    ){
+        // Allocate array for initial tones
+        std::complex<double> tones[4];
+        // Initialize them
+        for (size_t i = 0; i < 4; ++i)
+            tones[i] = std::complex<double>(std::cos(startPhase + i*2*M_PI*freq), std::sin(startPhase + i*2*M_PI*freq));
+
+        // Compute the step
+        std::complex<double> step(std::cos(2*M_PI*freq*4), std::sin(2*M_PI*freq*4));
+
+        // Main loop
+        for (size_t i = 0; i < size-size%4; i += 4)
+        {
+            // Multiply into output
+            realMulIntrinsic_2x2_64fc(&in[i+0], &tones[0], &out[i+0]);
+            realMulIntrinsic_2x2_64fc(&in[i+2], &tones[2], &out[i+2]);
 
             // Increment tones
             complexMulIntrinsic_2xScalar(step, &tones[0]);
@@ -238,26 +491,278 @@ namespace ffs
         // Remaining loops
         for (size_t i = 0; i < size % 4; ++i)
         {
-            array[size-size%4 + i] = array[size-size%4 + i] * tones[i];
+            out[size-size%4 + i] = in[size-size%4 + i] * tones[i];
         }
     }
 
 
-    /// @brief Shift an input complex vector by a normalized frequency and start phase.
-    /// @tparam T Data type of real/imag sample.
-    /// @tparam U Data type for the tone and step real/imag values.
-    /// @tparam 4 Optimization parameter. Defaults to 1.
-    /// @param vec Input complex vector. Will be overwritten with the shifted values.
+    /// @brief Shift a real input vector by a normalized frequency and start phase, into a complex output vector.
+    /// @tparam T Data type of input real sample.
+    /// @tparam U Data type of output real/imag sample.
+    /// @param in Input real vector.
+    /// @param out Output complex vector. Will be resized to match the input.
     /// @param freq Normalized frequency i.e. [0, 1)
     /// @param startPhase Start phase of the frequency shift in radians.
+    template <typename T, typename U>
+    void shiftRealVector(
+        const std::vector<T> &in,
+        std::vector<std::complex<U>> &out,
+        const double freq,
+        const double startPhase
+    ){
+        out.resize(in.size());
+        // Call the shiftRealArray function
+        shiftRealArray<T, U>(in.data(), out.data(), in.size(), freq, startPhase);
+    };
+
+
+    /// @brief Shift an interleaved multi-channel complex array, with a separate normalized frequency and start phase per channel.
+    /// The samples are laid out as array[t*numChannels + c] for time step t and channel c.
+    /// @tparam T Data type of real/imag sample.
+    /// @param array Input interleaved complex array. Will be overwritten with the shifted values.
+    /// @param numChannels Number of interleaved channels.
+    /// @param size Number of time steps i.e. the length of each channel.
+    /// @param freqs Normalized frequency i.e. [0, 1) for each channel.
+    /// @param startPhases Start phase of the frequency shift in radians for each channel.
     template <typename T>
-    void shiftVector(
+    void shiftInterleavedArray(
+        std::complex<T> *array,
+        const size_t numChannels,
+        const size_t size,
+        const double *freqs,
+        const double *startPhases
+    );
+
+
+    template <>
+    inline void shiftInterleavedArray(
+        std::complex<float> *array,
+        const size_t numChannels,
+        const size_t size,
+        const double *freqs,
+        const double *startPhases
+    ){
+        if (numChannels == 0)
+            return;
+
+        // The tones cover the smallest whole number of time steps that is a multiple of 4 samples,
+        // so each 4-tone register always lines up with the same channels in every block
+        size_t block = numChannels;
+        while (block % 4 != 0)
+            block += numChannels;
+        const size_t stepsPerBlock = block / numChannels;
+
+        // Allocate and initialize the tones and steps for each position in the block
+        std::vector<std::complex<double>> tones(block);
+        std::vector<std::complex<double>> steps(block);
+        for (size_t j = 0; j < block; ++j)
+        {
+            size_t c = j % numChannels;
+            size_t t = j / numChannels;
+            tones[j] = std::complex<double>(std::cos(startPhases[c] + t*2*M_PI*freqs[c]), std::sin(startPhases[c] + t*2*M_PI*freqs[c]));
+            steps[j] = std::complex<double>(std::cos(2*M_PI*freqs[c]*stepsPerBlock), std::sin(2*M_PI*freqs[c]*stepsPerBlock));
+        }
+
+        const size_t total = numChannels * size;
+
+        // Allocate stack array for input
+        std::complex<double> input[4];
+
+        // Main loop
+        for (size_t i = 0; i < total-total%block; i += block)
+        {
+            for (size_t j = 0; j < block; j += 4)
+            {
+                // Cast the input to double
+                floatToDoubleIntrinsic8(
+                    reinterpret_cast<float*>(&array[i+j]),
+                    reinterpret_cast<double*>(input)
+                );
+
+                // Muliply with double type tones
+                complexMulIntrinsic_2x2_64fc(&tones[j+0], &input[0]);
+                complexMulIntrinsic_2x2_64fc(&tones[j+2], &input[2]);
+
+                // Load back to our input
+                doubleToFloatIntrinsic8(
+                    reinterpret_cast<double*>(input),
+                    reinterpret_cast<float*>(&array[i+j])
+                );
+
+                // Increment tones, each by its own channel's step
+                complexMulIntrinsic_2x2_64fc(&steps[j+0], &tones[j+0]);
+                complexMulIntrinsic_2x2_64fc(&steps[j+2], &tones[j+2]);
+            }
+        }
+
+        // Remainder loop
+        for (size_t j = 0; j < total % block; ++j)
+        {
+            array[total-total%block + j] = static_cast<std::complex<float>>(
+                static_cast<std::complex<double>>(array[total-total%block + j]) * tones[j]
+            );
+        }
+    };
+
+    template <>
+    inline void shiftInterleavedArray(
+        std::complex<double> *array,
+        const size_t numChannels,
+        const size_t size,
+        const double *freqs,
+        const double *startPhases
+    ){
+        if (numChannels == 0)
+            return;
+
+        // The tones cover the smallest whole number of time steps that is a multiple of 4 samples,
+        // so each 4-tone register always lines up with the same channels in every block
+        size_t block = numChannels;
+        while (block % 4 != 0)
+            block += numChannels;
+        const size_t stepsPerBlock = block / numChannels;
+
+        // Allocate and initialize the tones and steps for each position in the block
+        std::vector<std::complex<double>> tones(block);
+        std::vector<std::complex<double>> steps(block);
+        for (size_t j = 0; j < block; ++j)
+        {
+            size_t c = j % numChannels;
+            size_t t = j / numChannels;
+            tones[j] = std::complex<double>(std::cos(startPhases[c] + t*2*M_PI*freqs[c]), std::sin(startPhases[c] + t*2*M_PI*freqs[c]));
+            steps[j] = std::complex<double>(std::cos(2*M_PI*freqs[c]*stepsPerBlock), std::sin(2*M_PI*freqs[c]*stepsPerBlock));
+        }
+
+        const size_t total = numChannels * size;
+
+        // Main loop
+        for (size_t i = 0; i < total-total%block; i += block)
+        {
+            for (size_t j = 0; j < block; j += 4)
+            {
+                // Multiply into array
+                complexMulIntrinsic_2x2_64fc(&tones[j+0], &array[i+j+0]);
+                complexMulIntrinsic_2x2_64fc(&tones[j+2], &array[i+j+2]);
+
+                // Increment tones, each by its own channel's step
+                complexMulIntrinsic_2x2_64fc(&steps[j+0], &tones[j+0]);
+                complexMulIntrinsic_2x2_64fc(&steps[j+2], &tones[j+2]);
+            }
+        }
+
+        // Remaining loops
+        for (size_t j = 0; j < total % block; ++j)
+        {
+            array[total-total%block + j] = array[total-total%block + j] * tones[j];
+        }
+    }
+
+
+    /// @brief Shift an interleaved multi-channel complex vector, with a separate normalized frequency and start phase per channel.
+    /// @tparam T Data type of real/imag sample.
+    /// @param vec Input interleaved complex vector. Will be overwritten with the shifted values.
+    ///            Any trailing partial time step is left untouched.
+    /// @param freqs Normalized frequency i.e. [0, 1) for each channel. The number of channels is taken from its length.
+    /// @param startPhases Start phase of the frequency shift in radians for each channel. Throws std::invalid_argument if not the same length as freqs.
+    template <typename T>
+    void shiftInterleavedVector(
         std::vector<std::complex<T>> &vec,
+        const std::vector<double> &freqs,
+        const std::vector<double> &startPhases
+    ){
+        if (startPhases.size() != freqs.size())
+            throw std::invalid_argument("Number of start phases does not match the number of frequencies");
+        if (freqs.size() == 0)
+            return;
+
+        // Call the shiftInterleavedArray function
+        shiftInterleavedArray<T>(vec.data(), freqs.size(), vec.size() / freqs.size(), freqs.data(), startPhases.data());
+    };
+
+
+    /// @brief Shift an input complex half-precision array by a normalized frequency and start phase.
+    /// Without F16C the conversions fall back to the scalar ones in ffs_half.h.
+    /// @param array Input interleaved fp16 array (see ffs_half.h), of length 2*size. Will be overwritten with the shifted values.
+    /// @param size Number of complex samples in the input array.
+    /// @param freq Normalized frequency i.e. [0, 1)
+    /// @param startPhase Start phase of the frequency shift in radians.
+    inline void shiftArray16fc(
+        uint16_t *array,
+        const size_t size,
         const double freq,
         const double startPhase
     ){
-        // Call the shiftArray function
-        shiftArray<T>(vec.data(), vec.size(), freq, startPhase);
+        // Allocate array for initial tones
+        std::complex<double> tones[4];
+
+        // Initialize them
+        for (size_t i = 0; i < 4; ++i)
+        {
+            tones[i] = std::complex<double>(std::cos(startPhase + i*2*M_PI*freq), std::sin(startPhase + i*2*M_PI*freq));
+        }
+
+        // Compute the step
+        std::complex<double> step(std::cos(2*M_PI*freq*4), std::sin(2*M_PI*freq*4));
+
+        // Allocate stack arrays for input
+        float inputf[8];
+        std::complex<double> input[4];
+
+        // Main loop
+        for (size_t i = 0; i < size-size%4; i += 4)
+        {
+            // Cast the input to float
+#ifdef FFS_HAS_F16C
+            halfToFloatIntrinsic8(&array[2*i], inputf);
+#else
+            for (size_t j = 0; j < 8; ++j)
+                inputf[j] = halfToFloat(array[2*i + j]);
+#endif
+
+            // And then to double
+            floatToDoubleIntrinsic8(inputf, reinterpret_cast<double*>(input));
+
+            // Muliply with double type tones
+            complexMulIntrinsic_2x2_64fc(&tones[0], &input[0]);
+            complexMulIntrinsic_2x2_64fc(&tones[2], &input[2]);
+
+            // Cast back down to float, and then to half
+            doubleToFloatIntrinsic8(reinterpret_cast<double*>(input), inputf);
+#ifdef FFS_HAS_F16C
+            floatToHalfIntrinsic8(inputf, &array[2*i]);
+#else
+            for (size_t j = 0; j < 8; ++j)
+                array[2*i + j] = floatToHalf(inputf[j]);
+#endif
+
+            // Increment tones
+            complexMulIntrinsic_2xScalar(step, &tones[0]);
+            complexMulIntrinsic_2xScalar(step, &tones[2]);
+        }
+
+        // Remainder loop
+        for (size_t i = 0; i < size % 4; ++i)
+        {
+            size_t k = 2*(size-size%4 + i);
+            std::complex<double> x(halfToFloat(array[k]), halfToFloat(array[k+1]));
+            x *= tones[i];
+            array[k] = floatToHalf(static_cast<float>(x.real()));
+            array[k+1] = floatToHalf(static_cast<float>(x.imag()));
+        }
+    };
+
+
+    /// @brief Shift an input complex half-precision vector by a normalized frequency and start phase.
+    /// @param vec Input interleaved fp16 vector (see ffs_half.h). Will be overwritten with the shifted values.
+    /// @param freq Normalized frequency i.e. [0, 1)
+    /// @param startPhase Start phase of the frequency shift in radians.
+    inline void shiftVector16fc(
+        std::vector<uint16_t> &vec,
+        const double freq,
+        const double startPhase
+    ){
+        // Call the shiftArray16fc function
+        shiftArray16fc(vec.data(), vec.size() / 2, freq, startPhase);
     };
 
 }
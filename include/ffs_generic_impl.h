@@ -4,6 +4,10 @@
 #include <cmath>
 #include <complex>
 #include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+#include "ffs_half.h"
 
 #ifdef __APPLE__
 namespace ffsh
@@ -11,9 +15,44 @@ namespace ffsh
 namespace ffs
 #endif
 {
+    /// @brief Shift an input complex array using precomputed tones; this is the kernel behind shiftArray.
+    /// ShiftPlan (see ffs_plan.h) calls this directly to pick the unroll.
+    /// @tparam UNROLL Number of tones, and samples per iteration.
+    /// @tparam T Data type of real/imag sample.
+    /// @param array Input complex array. Will be overwritten with the shifted values.
+    /// @param size Length of the input array.
+    /// @param tones Tones for the first UNROLL samples. Will be overwritten.
+    /// @param step Tone increment over UNROLL samples.
+    template <size_t UNROLL, typename T>
+    void shiftArrayWithTones(
+        std::complex<T> *array,
+        const size_t size,
+        std::complex<double> *tones,
+        const std::complex<double> &step
+    ){
+        // Main loop
+        for (size_t i = 0; i < size-size%UNROLL; i += UNROLL)
+        {
+            // Fixed trip count, so the compiler unrolls these
+            for (size_t j = 0; j < UNROLL; ++j)
+                array[i+j] *= tones[j];
+
+            // Adjust tones
+            for (size_t j = 0; j < UNROLL; ++j)
+                tones[j] *= step;
+        }
+       
+        // Remainder loop
+        for (size_t i = 0; i < size % UNROLL; ++i)
+        {
+            array[size-size%UNROLL + i] *= tones[i];
+            tones[i] *= step;
+        }
+    };
+
+
     /// @brief Shift an input complex array by a normalized frequency and start phase.
     /// @tparam T Data type of real/imag sample.
-    /// @tparam double Data type for the tone and step real/imag values.
     /// @param array Input complex array. Will be overwritten with the shifted values.
     /// @param size Length of the input array.
     /// @param freq Normalized frequency i.e. [0, 1)
@@ -34,14 +73,61 @@ namespace ffs
         // Compute the step
         std::complex<double> step(std::cos(2*M_PI*freq*4), std::sin(2*M_PI*freq*4));
 
+        shiftArrayWithTones<4>(array, size, tones, step);
+    };
+
+
+    /// @brief Shift an input complex vector by a normalized frequency and start phase.
+    /// @tparam T Data type of real/imag sample.
+    /// @tparam double Data type for the tone and step real/imag values.
+    /// @tparam doubleNROLL Optimization parameter. Defaults to 1.
+    /// @param vec Input complex vector. Will be overwritten with the shifted values.
+    /// @param freq Normalized frequency i.e. [0, 1)
+    /// @param startPhase Start phase of the frequency shift in radians.
+    template <typename T>
+    void shiftVector(
+        std::vector<std::complex<T>> &vec,
+        const double freq,
+        const double startPhase
+    ){
+        // Call the shiftArray function
+        shiftArray<T>(vec.data(), vec.size(), freq, startPhase);
+    };
+
+
+    /// @brief Shift a real input array by a normalized frequency and start phase, into a complex output array.
+    /// @tparam T Data type of input real sample.
+    /// @tparam U Data type of output real/imag sample.
+    /// @param in Input real array.
+    /// @param out Output complex array. Must have at least size elements.
+    /// @param size Length of the input array.
+    /// @param freq Normalized frequency i.e. [0, 1)
+    /// @param startPhase Start phase of the frequency shift in radians.
+    template <typename T, typename U>
+    void shiftRealArray(
+        const T *in,
+        std::complex<U> *out,
+        const size_t size,
+        const double freq,
+        const double startPhase
+    ){
+        // Allocate array for initial tones
+        std::complex<double> tones[4];
+        // Initialize them
+        for (size_t i = 0; i < 4; ++i)
+            tones[i] = std::complex<double>(std::cos(startPhase + i*2*M_PI*freq), std::sin(startPhase + i*2*M_PI*freq));
+
+        // Compute the step
+        std::complex<double> step(std::cos(2*M_PI*freq*4), std::sin(2*M_PI*freq*4));
+
         // Main loop
         for (size_t i = 0; i < size-size%4; i += 4)
         {
-            // Explicitly unroll
-            array[i+0] *= tones[0];
-            array[i+1] *= tones[1];
-            array[i+2] *= tones[2];
-            array[i+3] *= tones[3];
+            // Explicitly unroll; real * complex only needs 2 multiplies
+            out[i+0] = static_cast<std::complex<U>>(static_cast<double>(in[i+0]) * tones[0]);
+            out[i+1] = static_cast<std::complex<U>>(static_cast<double>(in[i+1]) * tones[1]);
+            out[i+2] = static_cast<std::complex<U>>(static_cast<double>(in[i+2]) * tones[2]);
+            out[i+3] = static_cast<std::complex<U>>(static_cast<double>(in[i+3]) * tones[3]);
 
             // Adjust tones
             tones[0] *= step;
@@ -49,31 +135,168 @@ namespace ffs
             tones[2] *= step;
             tones[3] *= step;
         }
-       
+
         // Remainder loop
         for (size_t i = 0; i < size % 4; ++i)
         {
-            array[size-size%4 + i] *= tones[i];
-            tones[i] *= step;
+            out[size-size%4 + i] = static_cast<std::complex<U>>(
+                static_cast<double>(in[size-size%4 + i]) * tones[i]
+            );
         }
     };
 
 
-    /// @brief Shift an input complex vector by a normalized frequency and start phase.
-    /// @tparam T Data type of real/imag sample.
-    /// @tparam double Data type for the tone and step real/imag values.
-    /// @tparam doubleNROLL Optimization parameter. Defaults to 1.
-    /// @param vec Input complex vector. Will be overwritten with the shifted values.
+    /// @brief Shift a real input vector by a normalized frequency and start phase, into a complex output vector.
+    /// @tparam T Data type of input real sample.
+    /// @tparam U Data type of output real/imag sample.
+    /// @param in Input real vector.
+    /// @param out Output complex vector. Will be resized to match the input.
     /// @param freq Normalized frequency i.e. [0, 1)
     /// @param startPhase Start phase of the frequency shift in radians.
+    template <typename T, typename U>
+    void shiftRealVector(
+        const std::vector<T> &in,
+        std::vector<std::complex<U>> &out,
+        const double freq,
+        const double startPhase
+    ){
+        out.resize(in.size());
+        // Call the shiftRealArray function
+        shiftRealArray<T, U>(in.data(), out.data(), in.size(), freq, startPhase);
+    };
+
+
+    /// @brief Shift an interleaved multi-channel complex array, with a separate normalized frequency and start phase per channel.
+    /// The samples are laid out as array[t*numChannels + c] for time step t and channel c.
+    /// @tparam T Data type of real/imag sample.
+    /// @param array Input interleaved complex array. Will be overwritten with the shifted values.
+    /// @param numChannels Number of interleaved channels.
+    /// @param size Number of time steps i.e. the length of each channel.
+    /// @param freqs Normalized frequency i.e. [0, 1) for each channel.
+    /// @param startPhases Start phase of the frequency shift in radians for each channel.
     template <typename T>
-    void shiftVector(
+    void shiftInterleavedArray(
+        std::complex<T> *array,
+        const size_t numChannels,
+        const size_t size,
+        const double *freqs,
+        const double *startPhases
+    ){
+        if (numChannels == 0)
+            return;
+
+        // The tones cover the smallest whole number of time steps that is a multiple of 4 samples,
+        // so each 4-tone register always lines up with the same channels in every block
+        size_t block = numChannels;
+        while (block % 4 != 0)
+            block += numChannels;
+        const size_t stepsPerBlock = block / numChannels;
+
+        // Allocate and initialize the tones and steps for each position in the block
+        std::vector<std::complex<double>> tones(block);
+        std::vector<std::complex<double>> steps(block);
+        for (size_t j = 0; j < block; ++j)
+        {
+            size_t c = j % numChannels;
+            size_t t = j / numChannels;
+            tones[j] = std::complex<double>(std::cos(startPhases[c] + t*2*M_PI*freqs[c]), std::sin(startPhases[c] + t*2*M_PI*freqs[c]));
+            steps[j] = std::complex<double>(std::cos(2*M_PI*freqs[c]*stepsPerBlock), std::sin(2*M_PI*freqs[c]*stepsPerBlock));
+        }
+
+        const size_t total = numChannels * size;
+
+        // Main loop
+        for (size_t i = 0; i < total-total%block; i += block)
+        {
+            for (size_t j = 0; j < block; ++j)
+            {
+                array[i+j] *= tones[j];
+                tones[j] *= steps[j];
+            }
+        }
+
+        // Remainder loop
+        for (size_t j = 0; j < total % block; ++j)
+        {
+            array[total-total%block + j] *= tones[j];
+        }
+    };
+
+
+    /// @brief Shift an interleaved multi-channel complex vector, with a separate normalized frequency and start phase per channel.
+    /// @tparam T Data type of real/imag sample.
+    /// @param vec Input interleaved complex vector. Will be overwritten with the shifted values.
+    ///            Any trailing partial time step is left untouched.
+    /// @param freqs Normalized frequency i.e. [0, 1) for each channel. The number of channels is taken from its length.
+    /// @param startPhases Start phase of the frequency shift in radians for each channel. Throws std::invalid_argument if not the same length as freqs.
+    template <typename T>
+    void shiftInterleavedVector(
         std::vector<std::complex<T>> &vec,
+        const std::vector<double> &freqs,
+        const std::vector<double> &startPhases
+    ){
+        if (startPhases.size() != freqs.size())
+            throw std::invalid_argument("Number of start phases does not match the number of frequencies");
+        if (freqs.size() == 0)
+            return;
+
+        // Call the shiftInterleavedArray function
+        shiftInterleavedArray<T>(vec.data(), freqs.size(), vec.size() / freqs.size(), freqs.data(), startPhases.data());
+    };
+
+
+    /// @brief Shift an input complex half-precision array by a normalized frequency and start phase.
+    /// @param array Input interleaved fp16 array (see ffs_half.h), of length 2*size. Will be overwritten with the shifted values.
+    /// @param size Number of complex samples in the input array.
+    /// @param freq Normalized frequency i.e. [0, 1)
+    /// @param startPhase Start phase of the frequency shift in radians.
+    inline void shiftArray16fc(
+        uint16_t *array,
+        const size_t size,
         const double freq,
         const double startPhase
     ){
-        // Call the shiftArray function
-        shiftArray<T>(vec.data(), vec.size(), freq, startPhase);
+        // Allocate array for initial tones
+        std::complex<double> tones[4];
+        // Initialize them
+        for (size_t i = 0; i < 4; ++i)
+            tones[i] = std::complex<double>(std::cos(startPhase + i*2*M_PI*freq), std::sin(startPhase + i*2*M_PI*freq));
+
+        // Compute the step
+        std::complex<double> step(std::cos(2*M_PI*freq*4), std::sin(2*M_PI*freq*4));
+
+        // Main loop
+        for (size_t i = 0; i < size; i += 4)
+        {
+            for (size_t j = 0; j < 4 && i + j < size; ++j)
+            {
+                // Widen, shift and narrow back
+                std::complex<double> x(
+                    halfToFloat(array[2*(i+j)]),
+                    halfToFloat(array[2*(i+j)+1])
+                );
+                x *= tones[j];
+                array[2*(i+j)] = floatToHalf(static_cast<float>(x.real()));
+                array[2*(i+j)+1] = floatToHalf(static_cast<float>(x.imag()));
+
+                // Adjust tone
+                tones[j] *= step;
+            }
+        }
+    };
+
+
+    /// @brief Shift an input complex half-precision vector by a normalized frequency and start phase.
+    /// @param vec Input interleaved fp16 vector (see ffs_half.h). Will be overwritten with the shifted values.
+    /// @param freq Normalized frequency i.e. [0, 1)
+    /// @param startPhase Start phase of the frequency shift in radians.
+    inline void shiftVector16fc(
+        std::vector<uint16_t> &vec,
+        const double freq,
+        const double startPhase
+    ){
+        // Call the shiftArray16fc function
+        shiftArray16fc(vec.data(), vec.size() / 2, freq, startPhase);
     };
 
 }
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+
+#ifdef __APPLE__
+namespace ffsh
+#else
+namespace ffs
+#endif
+{
+    /*
+    There is no portable half-precision type in C++11, so fp16 samples are
+    passed around as their raw IEEE 754 binary16 bit patterns in uint16_t.
+    Complex fp16 arrays are interleaved i.e. [re0, im0, re1, im1, ...].
+    These scalar conversions are used by the generic implementation, and for
+    the remainder loops of the AVX implementation.
+    Bit casts go through a union rather than memcpy, as <cstring> drags in glibc's
+    ffs() from <strings.h> under _GNU_SOURCE, which clashes with our namespace.
+    */
+
+    union HalfFloatBits
+    {
+        uint32_t u;
+        float f;
+    };
+
+    /// @brief Converts a binary16 bit pattern to a float.
+    static inline float halfToFloat(const uint16_t h)
+    {
+        uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+        uint32_t exp = (h >> 10) & 0x1F;
+        uint32_t mant = h & 0x3FF;
+        HalfFloatBits bits;
+
+        if (exp == 0)
+        {
+            if (mant == 0)
+            {
+                // Signed zero
+                bits.u = sign;
+            }
+            else
+            {
+                // Subnormal half; renormalize for the float
+                exp = 1;
+                while (!(mant & 0x400))
+                {
+                    mant <<= 1;
+                    --exp;
+                }
+                mant &= 0x3FF;
+                bits.u = sign | ((exp + 112) << 23) | (mant << 13);
+            }
+        }
+        else if (exp == 0x1F)
+        {
+            // Inf / NaN (quieted, as F16C does)
+            bits.u = sign | 0x7F800000 | (mant << 13) | (mant ? 0x00400000 : 0);
+        }
+        else
+        {
+            bits.u = sign | ((exp + 112) << 23) | (mant << 13);
+        }
+
+        return bits.f;
+    }
+
+    /// @brief Converts a float to a binary16 bit pattern, rounding to nearest even.
+    static inline uint16_t floatToHalf(const float f)
+    {
+        HalfFloatBits bits;
+        bits.f = f;
+        uint32_t x = bits.u;
+
+        uint32_t sign = (x >> 16) & 0x8000;
+        uint32_t mant = x & 0x007FFFFF;
+        int32_t exp = static_cast<int32_t>((x >> 23) & 0xFF);
+
+        // Inf / NaN; NaNs are quieted and keep the top of their payload, as F16C does
+        if (exp == 0xFF)
+            return static_cast<uint16_t>(sign | 0x7C00 | (mant ? 0x200 | (mant >> 13) : 0));
+
+        // Rebias the exponent
+        exp = exp - 127 + 15;
+
+        // Overflow to inf
+        if (exp >= 0x1F)
+            return static_cast<uint16_t>(sign | 0x7C00);
+
+        // Subnormal half, or underflow to zero
+        if (exp <= 0)
+        {
+            if (exp < -10)
+                return static_cast<uint16_t>(sign);
+
+            mant |= 0x00800000; // Implicit leading bit
+            uint32_t shift = static_cast<uint32_t>(14 - exp);
+            uint32_t half = mant >> shift;
+            uint32_t rem = mant & ((1u << shift) - 1);
+            uint32_t mid = 1u << (shift - 1);
+            if (rem > mid || (rem == mid && (half & 1)))
+                ++half;
+            return static_cast<uint16_t>(sign | half);
+        }
+
+        // Normal half; a carry out of the mantissa correctly bumps the exponent
+        uint32_t half = (static_cast<uint32_t>(exp) << 10) | (mant >> 13);
+        uint32_t rem = mant & 0x1FFF;
+        if (rem > 0x1000 || (rem == 0x1000 && (half & 1)))
+            ++half;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+}
@@ -0,0 +1,444 @@
+#pragma once
+
+#include "ffs.h"
+
+#include <chrono>
+#include <complex>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __APPLE__
+namespace ffsh
+#else
+namespace ffs
+#endif
+{
+    /*
+    FFTW-style plans for shiftArray.
+    The best kernel (unroll, number of threads) differs between machines and array sizes,
+    so a plan benchmarks the candidates once for a given size and keeps the fastest.
+    The choice can be exported as a wisdom string and imported later to skip the tuning.
+    */
+
+    /// @brief Flags for ShiftPlan creation. These can be OR'ed together.
+    enum ShiftPlanFlags
+    {
+        PLAN_ESTIMATE = 0,          ///< Don't benchmark; use the same kernel as shiftArray.
+        PLAN_MEASURE = 1 << 0,      ///< Benchmark the candidate kernels and keep the fastest.
+        PLAN_SINGLE_THREAD = 1 << 1 ///< Only consider single-threaded kernels.
+    };
+
+    /// @brief Names used to tag the sample type in wisdom strings.
+    template <typename T>
+    struct ShiftPlanTypeName;
+
+    template <>
+    struct ShiftPlanTypeName<float>
+    {
+        static const char *value() { return "cf32"; }
+    };
+
+    template <>
+    struct ShiftPlanTypeName<double>
+    {
+        static const char *value() { return "cf64"; }
+    };
+
+
+    /// @brief Persistent worker threads for a multi-threaded ShiftPlan,
+    /// so that threads aren't created and joined on every execute.
+    class ShiftPlanWorkers
+    {
+    public:
+        explicit ShiftPlanWorkers(const size_t numWorkers)
+            : m_task(nullptr), m_generation(0), m_pending(0), m_stop(false)
+        {
+            m_threads.reserve(numWorkers);
+            try
+            {
+                for (size_t i = 0; i < numWorkers; ++i)
+                    m_threads.emplace_back(&ShiftPlanWorkers::loop, this, i + 1);
+            }
+            catch (...)
+            {
+                // The destructor won't run, so stop and join whatever was started
+                stop();
+                throw;
+            }
+        }
+
+        ~ShiftPlanWorkers()
+        {
+            stop();
+        }
+
+        ShiftPlanWorkers(const ShiftPlanWorkers&) = delete;
+        ShiftPlanWorkers& operator=(const ShiftPlanWorkers&) = delete;
+
+        /// @brief Runs task(1..numWorkers) on the workers and task(0) on the calling thread.
+        /// Returns once all of them are done.
+        void run(const std::function<void(size_t)> &task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_task = &task;
+                m_pending = m_threads.size();
+                ++m_generation;
+            }
+            m_start.notify_all();
+
+            task(0);
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [this]{ return m_pending == 0; });
+        }
+
+    private:
+        std::vector<std::thread> m_threads;
+        std::mutex m_mutex;
+        std::condition_variable m_start;
+        std::condition_variable m_done;
+        const std::function<void(size_t)> *m_task;
+        size_t m_generation;
+        size_t m_pending;
+        bool m_stop;
+
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_start.notify_all();
+
+            for (auto &thread : m_threads)
+                thread.join();
+        }
+
+        void loop(const size_t index)
+        {
+            size_t seen = 0;
+            for (;;)
+            {
+                const std::function<void(size_t)> *task;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_start.wait(lock, [&]{ return m_stop || m_generation != seen; });
+                    if (m_stop)
+                        return;
+                    seen = m_generation;
+                    task = m_task;
+                }
+
+                (*task)(index);
+
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (--m_pending == 0)
+                        m_done.notify_one();
+                }
+            }
+        }
+    };
+
+
+    /// @brief A reusable plan for shifting complex arrays of a fixed size.
+    /// Multi-threaded plans keep their worker threads alive for the lifetime of the plan.
+    /// Plans are movable but not copyable, and must not be executed concurrently from several threads.
+    /// @tparam T Data type of real/imag sample. Only float and double are supported.
+    template <typename T>
+    class ShiftPlan
+    {
+    public:
+        /// @brief Creates a plan, benchmarking the candidate kernels if PLAN_MEASURE is set.
+        /// @param size Length of the arrays that will be executed with this plan.
+        /// @param flags Combination of ShiftPlanFlags.
+        ShiftPlan(const size_t size, const unsigned int flags = PLAN_MEASURE)
+            : m_size(size), m_flags(flags), m_numThreads(0)
+        {
+            setKernel(4, 1);
+
+            if (m_flags & PLAN_MEASURE)
+                measure();
+        }
+
+        /// @brief Creates a plan with an explicitly chosen kernel, without benchmarking.
+        /// @param size Length of the arrays that will be executed with this plan.
+        /// @param unroll Number of tones i.e. 4, 8 or 16.
+        /// @param numThreads Number of threads to split the array over. Clamped to maxThreads().
+        ShiftPlan(const size_t size, const size_t unroll, const size_t numThreads)
+            : m_size(size), m_flags(PLAN_ESTIMATE), m_numThreads(0)
+        {
+            if (unroll != 4 && unroll != 8 && unroll != 16)
+                throw std::invalid_argument("ShiftPlan unroll must be 4, 8 or 16");
+            if (numThreads == 0)
+                throw std::invalid_argument("ShiftPlan must have at least 1 thread");
+
+            // e.g. wisdom from a bigger machine shouldn't oversubscribe this one
+            setKernel(unroll, numThreads < maxThreads() ? numThreads : maxThreads());
+        }
+
+        /// @brief Shift an input complex array by a normalized frequency and start phase.
+        /// @param array Input complex array, of the plan's size. Will be overwritten with the shifted values.
+        /// @param freq Normalized frequency i.e. [0, 1)
+        /// @param startPhase Start phase of the frequency shift in radians.
+        void execute(
+            std::complex<T> *array,
+            const double freq,
+            const double startPhase
+        ){
+            // Only recompute the step and tones when the frequency changes
+            if (!m_cached || freq != m_freq)
+                prepare(freq);
+
+            std::complex<double> rotation(std::cos(startPhase), std::sin(startPhase));
+
+            if (m_numThreads == 1)
+            {
+                runChunk(array, 0, rotation);
+                return;
+            }
+
+            // The calling thread takes the first chunk
+            m_workers->run([this, array, rotation](size_t t){
+                runChunk(array, t, rotation);
+            });
+        }
+
+        /// @brief Shift an input complex vector by a normalized frequency and start phase.
+        /// @param vec Input complex vector, of the plan's size. Will be overwritten with the shifted values.
+        /// @param freq Normalized frequency i.e. [0, 1)
+        /// @param startPhase Start phase of the frequency shift in radians.
+        void execute(
+            std::vector<std::complex<T>> &vec,
+            const double freq,
+            const double startPhase
+        ){
+            if (vec.size() != m_size)
+                throw std::invalid_argument("Vector size does not match the ShiftPlan size");
+
+            execute(vec.data(), freq, startPhase);
+        }
+
+        /// @brief Serializes the chosen kernel, so that an equivalent plan can be created without tuning.
+        /// @return Wisdom string, to be passed to importWisdom().
+        std::string exportWisdom() const
+        {
+            std::ostringstream ss;
+            ss << "ffs-wisdom " << WISDOM_VERSION << " "
+               << ShiftPlanTypeName<T>::value() << " "
+               << m_size << " " << m_flags << " "
+               << m_unroll << " " << m_numThreads;
+            return ss.str();
+        }
+
+        /// @brief Creates a plan from a wisdom string, without tuning.
+        /// @param wisdom String from exportWisdom().
+        /// @return The plan. Throws std::invalid_argument if the wisdom is malformed or for another type.
+        static ShiftPlan<T> importWisdom(const std::string &wisdom)
+        {
+            // Split on whitespace; exactly the exported fields must be present
+            std::istringstream ss(wisdom);
+            std::vector<std::string> fields;
+            std::string field;
+            while (ss >> field)
+                fields.push_back(field);
+
+            if (fields.size() != 7 || fields[0] != "ffs-wisdom")
+                throw std::invalid_argument("Malformed ShiftPlan wisdom");
+            if (fields[1] != std::to_string(WISDOM_VERSION))
+                throw std::invalid_argument("Unsupported ShiftPlan wisdom version");
+            if (fields[2] != ShiftPlanTypeName<T>::value())
+                throw std::invalid_argument("ShiftPlan wisdom is for a different type");
+
+            size_t size = static_cast<size_t>(parseWisdomField(fields[3], std::numeric_limits<size_t>::max()));
+            unsigned int flags = static_cast<unsigned int>(parseWisdomField(fields[4], std::numeric_limits<unsigned int>::max()));
+            if (flags & ~static_cast<unsigned int>(PLAN_MEASURE | PLAN_SINGLE_THREAD))
+                throw std::invalid_argument("Unknown flags in ShiftPlan wisdom");
+            size_t unroll = static_cast<size_t>(parseWisdomField(fields[5], std::numeric_limits<size_t>::max()));
+            size_t numThreads = static_cast<size_t>(parseWisdomField(fields[6], std::numeric_limits<size_t>::max()));
+
+            ShiftPlan<T> plan(size, unroll, numThreads);
+            plan.m_flags = flags;
+            return plan;
+        }
+
+        /// @brief Upper bound on the number of threads a plan will use i.e. the hardware concurrency.
+        static size_t maxThreads()
+        {
+            // hardware_concurrency() may return 0 if it can't tell
+            size_t n = std::thread::hardware_concurrency();
+            return n > 0 ? n : 1;
+        }
+
+        size_t size() const { return m_size; }
+        unsigned int flags() const { return m_flags; }
+        size_t unroll() const { return m_unroll; }
+        size_t numThreads() const { return m_numThreads; }
+
+    private:
+        static const int WISDOM_VERSION = 1;
+        // Don't bother splitting across threads below this many samples each
+        static const size_t MIN_SAMPLES_PER_THREAD = 1 << 14;
+        static const int MEASURE_REPEATS = 5;
+
+        size_t m_size;
+        unsigned int m_flags;
+        size_t m_unroll;
+        size_t m_numThreads;
+        std::vector<size_t> m_chunkStarts; // numThreads + 1 boundaries
+        std::unique_ptr<ShiftPlanWorkers> m_workers; // numThreads - 1 workers, if multi-threaded
+
+        // Precomputed for the last frequency
+        bool m_cached;
+        double m_freq;
+        std::complex<double> m_step;
+        std::vector<std::complex<double>> m_tones; // tones for the first unroll samples, at zero phase
+        std::vector<std::complex<double>> m_chunkTones; // tone at the start of each chunk, at zero phase
+
+        static unsigned long long parseWisdomField(const std::string &field, const unsigned long long maxValue)
+        {
+            // Plain digits only; stoull would otherwise accept a sign and wrap negatives around
+            if (field.empty() || field.find_first_not_of("0123456789") != std::string::npos)
+                throw std::invalid_argument("Malformed ShiftPlan wisdom");
+
+            unsigned long long value;
+            try
+            {
+                value = std::stoull(field);
+            }
+            catch (const std::out_of_range&)
+            {
+                throw std::invalid_argument("Malformed ShiftPlan wisdom");
+            }
+
+            if (value > maxValue)
+                throw std::invalid_argument("Malformed ShiftPlan wisdom");
+            return value;
+        }
+
+        void setKernel(const size_t unroll, const size_t numThreads)
+        {
+            // Only respawn the workers when the thread count changes
+            if (numThreads != m_numThreads || (numThreads > 1 && !m_workers))
+            {
+                if (numThreads > 1)
+                    m_workers.reset(new ShiftPlanWorkers(numThreads - 1));
+                else
+                    m_workers.reset();
+            }
+
+            m_unroll = unroll;
+            m_numThreads = numThreads;
+
+            // Split into contiguous chunks, keeping each one a multiple of the unroll
+            size_t chunk = (m_size + numThreads - 1) / numThreads;
+            chunk = (chunk + unroll - 1) / unroll * unroll;
+            m_chunkStarts.resize(numThreads + 1);
+            for (size_t t = 0; t <= numThreads; ++t)
+                m_chunkStarts[t] = t * chunk < m_size ? t * chunk : m_size;
+
+            m_cached = false;
+        }
+
+        void prepare(const double freq)
+        {
+            m_tones.resize(m_unroll);
+            for (size_t i = 0; i < m_unroll; ++i)
+                m_tones[i] = std::complex<double>(std::cos(i*2*M_PI*freq), std::sin(i*2*M_PI*freq));
+
+            m_step = std::complex<double>(std::cos(2*M_PI*freq*m_unroll), std::sin(2*M_PI*freq*m_unroll));
+
+            m_chunkTones.resize(m_numThreads);
+            for (size_t t = 0; t < m_numThreads; ++t)
+            {
+                double start = static_cast<double>(m_chunkStarts[t]);
+                m_chunkTones[t] = std::complex<double>(std::cos(start*2*M_PI*freq), std::sin(start*2*M_PI*freq));
+            }
+
+            m_freq = freq;
+            m_cached = true;
+        }
+
+        void runChunk(
+            std::complex<T> *array,
+            const size_t t,
+            const std::complex<double> rotation
+        ) const {
+            // Rotate the cached tones to this chunk and start phase
+            std::complex<double> tones[16];
+            std::complex<double> chunkRotation = rotation * m_chunkTones[t];
+            for (size_t i = 0; i < m_unroll; ++i)
+                tones[i] = chunkRotation * m_tones[i];
+
+            std::complex<T> *chunk = array + m_chunkStarts[t];
+            const size_t len = m_chunkStarts[t+1] - m_chunkStarts[t];
+
+            switch (m_unroll)
+            {
+                case 4:
+                    shiftArrayWithTones<4>(chunk, len, tones, m_step);
+                    break;
+                case 8:
+                    shiftArrayWithTones<8>(chunk, len, tones, m_step);
+                    break;
+                case 16:
+                    shiftArrayWithTones<16>(chunk, len, tones, m_step);
+                    break;
+            }
+        }
+
+        void measure()
+        {
+            // Thread counts to try
+            std::vector<size_t> threadCounts(1, 1);
+            if (!(m_flags & PLAN_SINGLE_THREAD))
+            {
+                for (size_t n = 2; n <= maxThreads() && m_size / n >= MIN_SAMPLES_PER_THREAD; n *= 2)
+                    threadCounts.push_back(n);
+            }
+
+            const size_t unrolls[] = {4, 8, 16};
+
+            // Time on scratch data so the caller's arrays are never touched
+            std::vector<std::complex<T>> scratch(m_size, std::complex<T>(1, 0));
+
+            size_t bestUnroll = 4, bestThreads = 1;
+            double bestTime = std::numeric_limits<double>::max();
+            for (size_t unroll : unrolls)
+            {
+                for (size_t numThreads : threadCounts)
+                {
+                    setKernel(unroll, numThreads);
+
+                    // Keep the best of a few runs, which also discounts the warm-up
+                    for (int r = 0; r < MEASURE_REPEATS; ++r)
+                    {
+                        auto t1 = std::chrono::steady_clock::now();
+                        execute(scratch.data(), 0.1, 0.0);
+                        auto t2 = std::chrono::steady_clock::now();
+
+                        double elapsed = std::chrono::duration<double>(t2 - t1).count();
+                        if (elapsed < bestTime)
+                        {
+                            bestTime = elapsed;
+                            bestUnroll = unroll;
+                            bestThreads = numThreads;
+                        }
+                    }
+                }
+            }
+
+            setKernel(bestUnroll, bestThreads);
+        }
+    };
+
+}
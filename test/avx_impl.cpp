@@ -84,6 +84,37 @@ TEST_CASE("float to double cast", "[avx], [cast]")
 }
 
 
+////////////////////////////////////////////////////////////
+TEST_CASE("to double cast x4", "[avx], [cast]")
+{
+    SECTION("float array[4]")
+    {
+        float x[4] = {-2.0f, -1.5f, 0.0f, 3.25f};
+        double y[4];
+
+        floatToDoubleIntrinsic4(x, y);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(y[i] == static_cast<double>(x[i]));
+        }
+    }
+
+    SECTION("int16 array[4]")
+    {
+        int16_t x[4] = {-32768, -1, 0, 32767};
+        double y[4];
+
+        int16ToDoubleIntrinsic4(x, y);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(y[i] == static_cast<double>(x[i]));
+        }
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 TEST_CASE("complex multiply", "[avx], [multiply], [vecXvec]")
 {
@@ -139,6 +170,32 @@ TEST_CASE("complex multiply", "[avx], [multiply], [vecXvec]")
 }
 
 
+////////////////////////////////////////////////////////////
+TEST_CASE("real multiply", "[avx], [multiply], [real]")
+{
+    SECTION("double 2x2")
+    {
+        double x[2] = {3.0, -5.0};
+        std::complex<double> y[2] = {
+            std::complex<double>(1.0, 2.0),
+            std::complex<double>(-4.0, 6.0)
+        };
+        std::complex<double> z[2];
+
+        // Run the intrinsic
+        realMulIntrinsic_2x2_64fc(x, y, z);
+
+        // Check
+        for (int i = 0; i < 2; i++)
+        {
+            std::complex<double> check = x[i] * y[i];
+            REQUIRE(z[i].real() == check.real());
+            REQUIRE(z[i].imag() == check.imag());
+        }
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 
 TEST_CASE("complex multiply 2xScalar", "[avx], [multiply], [2xScalar]")
@@ -172,3 +229,45 @@ TEST_CASE("complex multiply 2xScalar", "[avx], [multiply], [2xScalar]")
 }
 
 
+////////////////////////////////////////////////////////////
+#ifdef FFS_HAS_F16C
+TEST_CASE("half to float cast", "[avx], [cast], [half]")
+{
+    SECTION("real array[8]")
+    {
+        float check[8] = {-4.0f, -3.0f, -2.0f, -1.0f, 0.0f, 0.5f, 2.0f, 65504.0f};
+        uint16_t x[8];
+        for (int i = 0; i < 8; ++i)
+            x[i] = floatToHalf(check[i]);
+
+        float y[8];
+        halfToFloatIntrinsic8(x, y);
+
+        for (int i = 0; i < 8; ++i)
+        {
+            REQUIRE(y[i] == check[i]);
+            REQUIRE(y[i] == halfToFloat(x[i]));
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+TEST_CASE("float to half cast", "[avx], [cast], [half]")
+{
+    SECTION("real array[8]")
+    {
+        // Includes values which need rounding, and a subnormal
+        float x[8] = {-4.0f, -3.1f, 1.0f/3.0f, 1e-6f, 0.0f, 2049.0f, 2051.0f, 1e5f};
+        uint16_t y[8];
+
+        floatToHalfIntrinsic8(x, y);
+
+        for (int i = 0; i < 8; ++i)
+        {
+            REQUIRE(y[i] == floatToHalf(x[i]));
+        }
+    }
+}
+#endif
+
@@ -1,6 +1,8 @@
 #include "ffs.h"
 #include <vector>
 #include <cmath>
+#include <string>
+#include <stdexcept>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/benchmark/catch_benchmark.hpp>
@@ -8,6 +10,7 @@
 
 #define SINGLE_REL_THRESHOLD_SHORT 1e-6 // for length 1e5
 #define SINGLE_REL_THRESHOLD_LONG 1e-5 // for length 1e8
+#define HALF_REL_THRESHOLD 1e-3
 
 template <typename T>
 void test_basic(size_t len, double freq, double phase, double threshold)
@@ -93,6 +96,188 @@ TEST_CASE("basic float", "[basic],[float]")
 }
 
 
+template <typename T, typename U>
+void test_real(size_t len, double freq, double phase, double threshold)
+{
+    // Create some real input
+    std::vector<T> data(len);
+    std::vector<std::complex<U>> out;
+
+    // Write some values to it
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = static_cast<T>(i%1000 + 1);
+
+    // Shift the data with our function
+    ffs::shiftRealVector<T, U>(data, out, freq, phase);
+    REQUIRE(out.size() == data.size());
+
+    // Check
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        std::complex<double> correct = static_cast<double>(data[i]) * std::complex<double>(
+            std::cos(2 * M_PI * freq * i + phase),
+            std::sin(2 * M_PI * freq * i + phase)
+        );
+
+        REQUIRE_THAT(
+            static_cast<double>(out[i].real()),
+            Catch::Matchers::WithinRel(correct.real(), threshold));
+        REQUIRE_THAT(
+            static_cast<double>(out[i].imag()),
+            Catch::Matchers::WithinRel(correct.imag(), threshold));
+    }
+}
+
+TEST_CASE("basic real", "[basic],[real]")
+{
+    SECTION("double, len 1e5, freq 1e-9, phase 0.1"){
+        test_real<double, double>(100000, 1e-9, 0.1, 1e-9);
+    }
+
+    SECTION("float, len 1e5, freq 1e-9, phase 0.1"){
+        test_real<float, float>(100000, 1e-9, 0.1, SINGLE_REL_THRESHOLD_SHORT);
+    }
+
+    SECTION("int16, len 1e5, freq 1e-9, phase 0.1"){
+        test_real<int16_t, float>(100000, 1e-9, 0.1, SINGLE_REL_THRESHOLD_SHORT);
+    }
+
+    // This is to check non-multiple of UNROLL lengths
+    SECTION("double, len 1e5-1, freq 1e-9, phase 0.1"){
+        test_real<double, double>(99999, 1e-9, 0.1, 1e-9);
+    }
+
+    SECTION("float, len 1e5-1, freq 1e-9, phase 0.1"){
+        test_real<float, float>(99999, 1e-9, 0.1, SINGLE_REL_THRESHOLD_SHORT);
+    }
+
+    SECTION("int16, len 1e5-1, freq 1e-9, phase 0.1"){
+        test_real<int16_t, float>(99999, 1e-9, 0.1, SINGLE_REL_THRESHOLD_SHORT);
+    }
+}
+
+template <typename T>
+void test_interleaved(size_t numChannels, size_t len, double threshold)
+{
+    // Give each channel a distinct frequency and phase
+    std::vector<double> freqs(numChannels);
+    std::vector<double> phases(numChannels);
+    for (size_t c = 0; c < numChannels; c++)
+    {
+        freqs[c] = 1e-3 * (c+1);
+        phases[c] = 0.1 * (c+1);
+    }
+
+    // Create some interleaved data
+    std::vector<std::complex<T>> data(len * numChannels);
+    std::vector<std::complex<T>> data2(data.size());
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = std::complex<T>(i%1000 + 1, i%1000 + 1);
+        data2[i] = data[i];
+    }
+
+    // Shift the data with our function
+    ffs::shiftInterleavedVector<T>(data, freqs, phases);
+
+    // Check; these frequencies pass through zero so compare against the magnitude instead
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        size_t c = i % numChannels;
+        size_t t = i / numChannels;
+        std::complex<double> correct = static_cast<std::complex<double>>(data2[i]) * std::complex<double>(
+            std::cos(2 * M_PI * freqs[c] * t + phases[c]),
+            std::sin(2 * M_PI * freqs[c] * t + phases[c])
+        );
+        double tol = threshold * std::abs(correct);
+
+        REQUIRE_THAT(
+            static_cast<double>(data[i].real()),
+            Catch::Matchers::WithinAbs(correct.real(), tol));
+        REQUIRE_THAT(
+            static_cast<double>(data[i].imag()),
+            Catch::Matchers::WithinAbs(correct.imag(), tol));
+    }
+}
+
+TEST_CASE("basic interleaved", "[basic],[interleaved]")
+{
+    // Channel counts which do and don't divide the unroll
+    const size_t channels[] = {1, 2, 3, 4, 5, 8};
+
+    for (size_t numChannels : channels)
+    {
+        SECTION("double, " + std::to_string(numChannels) + " channels, len 1e4+1"){
+            test_interleaved<double>(numChannels, 10001, 1e-9);
+        }
+
+        SECTION("float, " + std::to_string(numChannels) + " channels, len 1e4+1"){
+            test_interleaved<float>(numChannels, 10001, SINGLE_REL_THRESHOLD_SHORT);
+        }
+    }
+
+    SECTION("mismatched phases"){
+        std::vector<std::complex<float>> data(12);
+        std::vector<double> freqs = {1e-3, 2e-3, 3e-3};
+        std::vector<double> phases = {0.1, 0.2};
+        REQUIRE_THROWS_AS(ffs::shiftInterleavedVector<float>(data, freqs, phases), std::invalid_argument);
+    }
+}
+
+void test_half(size_t len, double freq, double phase, double threshold)
+{
+    // Create some interleaved half vectors
+    std::vector<uint16_t> data(len*2);
+    std::vector<uint16_t> data2(len*2);
+
+    // Write some values to it; these are all exactly representable in fp16
+    for (size_t i = 0; i < len; i++)
+    {
+        data[2*i] = ffs::floatToHalf(static_cast<float>(i%1000 + 1));
+        data[2*i+1] = data[2*i];
+        data2[2*i] = data[2*i];
+        data2[2*i+1] = data[2*i+1];
+    }
+
+    // Shift the data with our function
+    ffs::shiftVector16fc(data, freq, phase);
+
+    // Check
+    for (size_t i = 0; i < len; i++)
+    {
+        std::complex<double> correct = std::complex<double>(
+            ffs::halfToFloat(data2[2*i]), ffs::halfToFloat(data2[2*i+1])
+        ) * std::complex<double>(
+            std::cos(2 * M_PI * freq * i + phase),
+            std::sin(2 * M_PI * freq * i + phase)
+        );
+
+        double dreal = static_cast<double>(ffs::halfToFloat(data[2*i]));
+        double dimag = static_cast<double>(ffs::halfToFloat(data[2*i+1]));
+
+        REQUIRE_THAT(
+            dreal,
+            Catch::Matchers::WithinRel(correct.real(), threshold));
+        REQUIRE_THAT(
+            dimag,
+            Catch::Matchers::WithinRel(correct.imag(), threshold));
+    }
+}
+
+// fp16 only has an 11-bit significand, so the storage rounding dominates
+TEST_CASE("basic half", "[basic],[half]")
+{
+    SECTION("len 1e5, freq 1e-9, phase 0.1"){
+        test_half(100000, 1e-9, 0.1, HALF_REL_THRESHOLD);
+    }
+
+    // This is to check non-multiple of UNROLL lengths
+    SECTION("len 1e5-1, freq 1e-9, phase 0.1"){
+        test_half(99999, 1e-9, 0.1, HALF_REL_THRESHOLD);
+    }
+}
+
+
 /*
 //////////////////////////////////////////////////////////////////////////////////////////
 BENCHMARKS
@@ -197,3 +382,76 @@ TEST_CASE("benchmark float", "[benchmark],[float]")
     
 }
 
+TEST_CASE("benchmark real", "[benchmark],[real]")
+{
+    SECTION("float, len 1e6")
+    {
+        constexpr size_t len = 1000000;
+        std::vector<float> data(len);
+        std::vector<std::complex<float>> out(len);
+        for (size_t i = 0; i < data.size(); i++)
+            data[i] = static_cast<float>(i+1);
+
+        BENCHMARK("ffs")
+        {
+            return ffs::shiftRealVector<float, float>(data, out, 1e-9, 0.1);
+        };
+
+        // What we'd otherwise do: promote to complex and shift in place
+        BENCHMARK("promote + ffs")
+        {
+            for (size_t i = 0; i < data.size(); i++)
+                out[i] = std::complex<float>(data[i], 0.0f);
+            return benchmark_basic<float>(out);
+        };
+    }
+}
+
+TEST_CASE("benchmark interleaved", "[benchmark],[interleaved]")
+{
+    SECTION("float, 4 channels, len 1e6")
+    {
+        constexpr size_t numChannels = 4;
+        constexpr size_t len = 1000000;
+        std::vector<double> freqs = {1e-9, 2e-9, 3e-9, 4e-9};
+        std::vector<double> phases = {0.1, 0.2, 0.3, 0.4};
+        std::vector<std::complex<float>> data(len * numChannels);
+        for (size_t i = 0; i < data.size(); i++)
+            data[i] = std::complex<float>(i%1000 + 1, i%1000 + 1);
+
+        BENCHMARK("ffs")
+        {
+            return ffs::shiftInterleavedVector<float>(data, freqs, phases);
+        };
+
+        // What we'd otherwise do: de-interleave, shift each channel, re-interleave
+        std::vector<std::complex<float>> channel(len);
+        BENCHMARK("de-interleave + ffs")
+        {
+            for (size_t c = 0; c < numChannels; c++)
+            {
+                for (size_t i = 0; i < len; i++)
+                    channel[i] = data[i*numChannels + c];
+                ffs::shiftVector<float>(channel, freqs[c], phases[c]);
+                for (size_t i = 0; i < len; i++)
+                    data[i*numChannels + c] = channel[i];
+            }
+        };
+    }
+}
+
+TEST_CASE("benchmark half", "[benchmark],[half]")
+{
+    SECTION("len 1e6")
+    {
+        constexpr size_t len = 1000000;
+        std::vector<uint16_t> data(len*2);
+        for (size_t i = 0; i < data.size(); i++)
+            data[i] = ffs::floatToHalf(static_cast<float>(i%1000 + 1));
+
+        BENCHMARK("ffs")
+        {
+            return ffs::shiftVector16fc(data, 1e-9, 0.1);
+        };
+    }
+}
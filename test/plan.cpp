@@ -0,0 +1,191 @@
+#include "ffs_plan.h"
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#define SINGLE_REL_THRESHOLD_SHORT 1e-6 // for length 1e5
+
+template <typename T>
+void check_plan(ffs::ShiftPlan<T> &plan, double freq, double phase, double threshold)
+{
+    // Create some vectors
+    std::vector<std::complex<T>> data(plan.size());
+    std::vector<std::complex<T>> data2(plan.size());
+
+    // Write some values to it
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = std::complex<T>(i+1, i+1);
+        data2[i] = data[i];
+    }
+
+    // Shift the data with the plan
+    plan.execute(data, freq, phase);
+
+    // Check
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        std::complex<double> correct = static_cast<std::complex<double>>(data2[i]) * std::complex<double>(
+            std::cos(2 * M_PI * freq * i + phase),
+            std::sin(2 * M_PI * freq * i + phase)
+        );
+
+        REQUIRE_THAT(
+            static_cast<double>(data[i].real()),
+            Catch::Matchers::WithinRel(correct.real(), threshold));
+        REQUIRE_THAT(
+            static_cast<double>(data[i].imag()),
+            Catch::Matchers::WithinRel(correct.imag(), threshold));
+    }
+}
+
+
+TEST_CASE("plan kernels", "[plan]")
+{
+    const size_t unrolls[] = {4, 8, 16};
+    const size_t threads[] = {1, 3};
+
+    for (size_t unroll : unrolls)
+    {
+        for (size_t numThreads : threads)
+        {
+            // Odd length to check the remainders of every chunk
+            SECTION("double, unroll " + std::to_string(unroll) + ", " + std::to_string(numThreads) + " threads"){
+                ffs::ShiftPlan<double> plan(99999, unroll, numThreads);
+                check_plan(plan, 1e-9, 0.1, 1e-9);
+            }
+
+            SECTION("float, unroll " + std::to_string(unroll) + ", " + std::to_string(numThreads) + " threads"){
+                ffs::ShiftPlan<float> plan(99999, unroll, numThreads);
+                check_plan(plan, 1e-9, 0.1, SINGLE_REL_THRESHOLD_SHORT);
+            }
+        }
+    }
+
+    SECTION("invalid kernel"){
+        REQUIRE_THROWS_AS(ffs::ShiftPlan<float>(100, 5, 1), std::invalid_argument);
+        REQUIRE_THROWS_AS(ffs::ShiftPlan<float>(100, 4, 0), std::invalid_argument);
+    }
+
+    SECTION("thread count clamped to the hardware"){
+        ffs::ShiftPlan<float> plan(100000, 4, 100000);
+        REQUIRE(plan.numThreads() == ffs::ShiftPlan<float>::maxThreads());
+        check_plan(plan, 1e-9, 0.1, SINGLE_REL_THRESHOLD_SHORT);
+    }
+}
+
+TEST_CASE("plan measure", "[plan]")
+{
+    SECTION("double, len 1e5"){
+        ffs::ShiftPlan<double> plan(100000);
+        REQUIRE(plan.numThreads() >= 1);
+        check_plan(plan, 1e-9, 0.1, 1e-9);
+    }
+
+    SECTION("float, len 1e5"){
+        ffs::ShiftPlan<float> plan(100000);
+        REQUIRE(plan.numThreads() >= 1);
+        check_plan(plan, 1e-9, 0.1, SINGLE_REL_THRESHOLD_SHORT);
+    }
+
+    SECTION("float, single thread"){
+        ffs::ShiftPlan<float> plan(100000, ffs::PLAN_MEASURE | ffs::PLAN_SINGLE_THREAD);
+        REQUIRE(plan.numThreads() == 1);
+    }
+
+    SECTION("estimate"){
+        ffs::ShiftPlan<float> plan(100000, ffs::PLAN_ESTIMATE);
+        REQUIRE(plan.unroll() == 4);
+        REQUIRE(plan.numThreads() == 1);
+        check_plan(plan, 1e-9, 0.1, SINGLE_REL_THRESHOLD_SHORT);
+    }
+}
+
+TEST_CASE("plan reuse", "[plan]")
+{
+    // Executing with a new frequency must not reuse the old tones
+    ffs::ShiftPlan<double> plan(10001, 8, 2);
+    check_plan(plan, 1e-9, 0.1, 1e-9);
+    check_plan(plan, 2e-9, 0.2, 1e-9);
+    check_plan(plan, 2e-9, 0.3, 1e-9);
+
+    std::vector<std::complex<double>> wrongSize(10);
+    REQUIRE_THROWS_AS(plan.execute(wrongSize, 1e-9, 0.1), std::invalid_argument);
+}
+
+TEST_CASE("plan wisdom", "[plan]")
+{
+    SECTION("round trip"){
+        ffs::ShiftPlan<float> plan(100000, 16, 2);
+        std::string wisdom = plan.exportWisdom();
+
+        ffs::ShiftPlan<float> imported = ffs::ShiftPlan<float>::importWisdom(wisdom);
+        REQUIRE(imported.size() == plan.size());
+        REQUIRE(imported.unroll() == plan.unroll());
+        REQUIRE(imported.numThreads() == plan.numThreads());
+        REQUIRE(imported.exportWisdom() == wisdom);
+        check_plan(imported, 1e-9, 0.1, SINGLE_REL_THRESHOLD_SHORT);
+    }
+
+    SECTION("wrong type"){
+        ffs::ShiftPlan<float> plan(100, 4, 1);
+        REQUIRE_THROWS_AS(ffs::ShiftPlan<double>::importWisdom(plan.exportWisdom()), std::invalid_argument);
+    }
+
+    SECTION("malformed"){
+        REQUIRE_THROWS_AS(ffs::ShiftPlan<float>::importWisdom(""), std::invalid_argument);
+        // Surrounding whitespace is fine
+        REQUIRE(ffs::ShiftPlan<float>::importWisdom(" ffs-wisdom 1 cf32 100 1 4 1\n").unroll() == 4);
+        REQUIRE_THROWS_AS(ffs::ShiftPlan<float>::importWisdom("ffs-wisdom 1 cf32 100"), std::invalid_argument);
+        REQUIRE_THROWS_AS(ffs::ShiftPlan<float>::importWisdom("ffs-wisdom 1 cf32 100 1 7 1"), std::invalid_argument);
+        REQUIRE_THROWS_AS(ffs::ShiftPlan<float>::importWisdom("ffs-wisdom 1 cf32 100 1 4 1 garbage"), std::invalid_argument);
+        REQUIRE_THROWS_AS(ffs::ShiftPlan<float>::importWisdom("ffs-wisdom 1 cf32 -5 1 4 1"), std::invalid_argument);
+        REQUIRE_THROWS_AS(ffs::ShiftPlan<float>::importWisdom("ffs-wisdom 1 cf32 100 1 +4 1"), std::invalid_argument);
+        REQUIRE_THROWS_AS(ffs::ShiftPlan<float>::importWisdom("ffs-wisdom 1 cf32 99999999999999999999999 1 4 1"), std::invalid_argument);
+        REQUIRE_THROWS_AS(ffs::ShiftPlan<float>::importWisdom("ffs-wisdom 1 cf32 100 4294967295 4 1"), std::invalid_argument);
+        REQUIRE_THROWS_AS(ffs::ShiftPlan<float>::importWisdom("ffs-wisdom 1 cf32 100 4 4 1"), std::invalid_argument);
+    }
+
+    SECTION("from a bigger machine"){
+        // More threads than we have are clamped rather than spawned
+        ffs::ShiftPlan<float> plan = ffs::ShiftPlan<float>::importWisdom("ffs-wisdom 1 cf32 100 1 4 100000");
+        REQUIRE(plan.numThreads() == ffs::ShiftPlan<float>::maxThreads());
+
+        plan = ffs::ShiftPlan<float>::importWisdom("ffs-wisdom 1 cf32 100 3 4 18446744073709551615");
+        REQUIRE(plan.numThreads() == ffs::ShiftPlan<float>::maxThreads());
+    }
+}
+
+
+/*
+//////////////////////////////////////////////////////////////////////////////////////////
+BENCHMARKS
+//////////////////////////////////////////////////////////////////////////////////////////
+*/
+
+TEST_CASE("benchmark plan", "[benchmark],[plan]")
+{
+    SECTION("float, len 1e6")
+    {
+        constexpr size_t len = 1000000;
+        std::vector<std::complex<float>> data(len);
+        for (size_t i = 0; i < data.size(); i++)
+            data[i] = std::complex<float>(i+1, i+1);
+
+        ffs::ShiftPlan<float> plan(len);
+
+        BENCHMARK("plan")
+        {
+            return plan.execute(data, 1e-9, 0.1);
+        };
+
+        BENCHMARK("shiftVector")
+        {
+            return ffs::shiftVector<float>(data, 1e-9, 0.1);
+        };
+    }
+}